@@ -0,0 +1,104 @@
+#!/bin/sh
+#=========================================================================
+# This is OPEN SOURCE SOFTWARE governed by the Gnu General Public
+# License (GPL) version 3, as described at www.opensource.org.
+# Copyright (C)2022 William H. Majoros (bmajoros@alumni.duke.edu).
+#=========================================================================
+# Regression check for triobeast-infer at high read depth, where the
+# posterior on theta is far narrower than the coarse integration grid.
+# For each depth it writes a phased gene of 60 sites with the mother's
+# maternal copy under-expressed (theta=0.5) and inherited by the child,
+# plus a gene with no sites, and requires that triobeast-infer finishes
+# within a time limit, reports both genes, and puts the posterior
+# median of theta within 0.45-0.55.  It then checks the log prior
+# of several inheritance modes, with the recombination and de novo
+# rates integrated out, against the closed form
+# log B(1+N*a,B+N*b) - log B(1,B), and that a gene with no sites is
+# reported even when P(affected) is 0 or 1.  Run via "make check".
+
+INFER=${INFER:-./triobeast-infer}
+TMP=${TMPDIR:-/tmp}/check-infer-depth.$$
+trap 'rm -f $TMP.essex $TMP.out $TMP.priors' EXIT
+status=0
+for DEPTH in 200 1000 3000 10000 ; do
+  awk -v N=$DEPTH 'BEGIN {
+    k=int(N/3+0.5)
+    printf "(gene DEEP"
+    for(s=0 ; s<60 ; ++s)
+      printf " (site %d (genotypes (mother 0 1) (father 0 0) (child 0 1)) (counts (mother %d %d) (father %d 0) (child %d %d)) (phased 1))", s, k, N-k, N, k, N-k
+    print ")"
+    print "(gene EMPTY)"
+  }' > $TMP.essex
+  if ! timeout 60 $INFER $TMP.essex 0-1 1.2 0.01 > $TMP.out 2>/dev/null ; then
+    echo "depth $DEPTH: triobeast-infer failed or took over 60 seconds"
+    status=1
+    continue
+  fi
+  if ! awk -v D=$DEPTH '
+    $1=="DEEP" { deep=1; if($3<0.45 || $3>0.55) bad=$3 }
+    $1=="EMPTY" { empty=1 }
+    END {
+      if(!deep || !empty) { print "depth " D ": a gene is missing"; exit 1 }
+      if(bad!="") { print "depth " D ": median theta " bad; exit 1 }
+    }' $TMP.out ; then
+    status=1
+  else
+    echo "depth $DEPTH: ok"
+  fi
+done
+
+# Mode priors: N homozygous sites, so only the site count matters
+for N in 20 60 200 ; do
+  awk -v N=$N 'BEGIN {
+    printf "(gene G%d", N
+    for(s=0 ; s<N ; ++s)
+      printf " (site %d (genotypes (mother 0 0) (father 1 1) (child 0 1)) (counts (mother 10 0) (father 0 10) (child 5 5)) (phased 1))", s
+    print ")"
+  }' > $TMP.essex
+  if ! $INFER -P $TMP.priors $TMP.essex 0-0 1.2 0.01 > $TMP.out 2>/dev/null
+  then
+    echo "priors, $N sites: triobeast-infer failed"
+    status=1
+    continue
+  fi
+  # mode, then unaffected, affected, denovo, noDenovo, recomb, noRecomb
+  if ! awk -v N=$N -v PA=0.01 '
+    function lg(n,  k, x) { x=0; for(k=2 ; k<n ; ++k) x+=log(k); return x }
+    function lbm(a,b,B) { return lg(1+a)+lg(B+b)-lg(1+a+B+b)-lg(B)+lg(1+B) }
+    BEGIN {
+      split("1 4 0 0 2 0 0,2 4 0 1 1 0 0,5 3 1 0 2 1 0,13 2 2 0 2 1 1,15 2 2 0 2 2 0",
+	    rows,",")
+      for(i in rows) {
+	split(rows[i],r," ")
+	expect[r[1]]=N*(r[2]*log(1-PA)+r[3]*log(PA))+ \
+	  lbm(N*r[6],N*r[7],99)+lbm(N*r[4],N*r[5],999)
+      }
+    }
+    ($2 in expect) {
+      seen[$2]=1
+      d=$3-expect[$2]; if(d<0) d=-d
+      if(d>1e-6*(1-expect[$2])) {
+	print N " sites: mode " $2 " log prior " $3 ", expected " expect[$2]
+	bad=1
+      }
+    }
+    END { for(m in expect) if(!(m in seen)) bad=1; exit bad }' $TMP.priors
+  then
+    status=1
+  else
+    echo "priors, $N sites: ok"
+  fi
+done
+
+# An empty gene when P(affected) is 0 or 1
+echo "(gene EMPTY)" > $TMP.essex
+for PA in 0 1 ; do
+  if ! $INFER $TMP.essex 0-0 1.2 $PA 2>/dev/null |
+      awk '$1=="EMPTY" && !/nan/ { ok=1 } END { exit !ok }' ; then
+    echo "empty gene, P(affected)=$PA: not reported"
+    status=1
+  else
+    echo "empty gene, P(affected)=$PA: ok"
+  fi
+done
+exit $status
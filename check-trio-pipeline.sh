@@ -0,0 +1,69 @@
+#!/bin/sh
+#=========================================================================
+# This is OPEN SOURCE SOFTWARE governed by the Gnu General Public
+# License (GPL) version 3, as described at www.opensource.org.
+# Copyright (C)2022 William H. Majoros (bmajoros@alumni.duke.edu).
+#=========================================================================
+# Regression check that trio-pipeline's phased output is what
+# phase-trio makes from the pipeline's own data tap.  It writes a
+# small random VCF, runs trio-pipeline with -D, and phases the data
+# file with phase-trio.  phase-trio's batch path (-t) must match the
+# pipeline byte for byte, in both Essex and TrioStore format; its
+# default path reprints the parsed tree with other line breaks, so
+# that output must match once whitespace is normalized.  Run via
+# "make check".
+
+PIPELINE=${PIPELINE:-./trio-pipeline}
+PHASE=${PHASE:-./phase-trio}
+TMP=${TMPDIR:-/tmp}/check-trio-pipeline.$$
+trap 'rm -f $TMP.vcf $TMP.data $TMP.pipe $TMP.batch $TMP.tree $TMP.a $TMP.b' EXIT
+status=0
+
+awk 'BEGIN {
+  srand(17)
+  print "##fileformat=VCFv4.2"
+  print "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\tFORMAT\tM\tF\tX"
+  pos=100
+  for(g=0 ; g<40 ; ++g)
+    for(s=1+int(rand()*8) ; s>0 ; --s) {
+      pos+=10
+      printf "1\t%d\tG%d:%d\tC\tT\t.\t.\t.\tGT", pos, g, pos
+      for(i=0 ; i<3 ; ++i) printf "\t%d|%d", rand()<0.4, rand()<0.4
+      print ""
+    }
+}' > $TMP.vcf
+
+# Essex: batch path byte for byte, default path up to whitespace
+if ! $PIPELINE -s 5 -D $TMP.data $TMP.vcf M F 40 20 0.01 0.5 $TMP.pipe \
+     2>/dev/null ||
+   ! $PHASE -t 2 $TMP.data $TMP.batch 2>/dev/null ||
+   ! $PHASE $TMP.data $TMP.tree 2>/dev/null ; then
+  echo "essex: trio-pipeline or phase-trio failed"
+  status=1
+elif ! cmp -s $TMP.pipe $TMP.batch ; then
+  echo "essex: trio-pipeline differs from phase-trio -t"
+  status=1
+else
+  tr -s ' \t\n' '   ' < $TMP.pipe | sed 's/ )/)/g' > $TMP.a
+  tr -s ' \t\n' '   ' < $TMP.tree | sed 's/ )/)/g' > $TMP.b
+  if ! cmp -s $TMP.a $TMP.b ; then
+    echo "essex: trio-pipeline differs from phase-trio's default path"
+    status=1
+  else
+    echo "essex: ok"
+  fi
+fi
+
+# TrioStore: phase-trio takes the batch path for binary input
+if ! $PIPELINE -b -s 5 -D $TMP.data $TMP.vcf M F 40 20 0.01 0.5 $TMP.pipe \
+     2>/dev/null ||
+   ! $PHASE $TMP.data $TMP.batch 2>/dev/null ; then
+  echo "triostore: trio-pipeline or phase-trio failed"
+  status=1
+elif ! cmp -s $TMP.pipe $TMP.batch ; then
+  echo "triostore: trio-pipeline differs from phase-trio"
+  status=1
+else
+  echo "triostore: ok"
+fi
+exit $status